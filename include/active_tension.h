@@ -0,0 +1,134 @@
+#ifndef ACTIVE_TENSION_HPP
+#define ACTIVE_TENSION_HPP
+
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * Simple excitation-contraction coupling model for the active tension \\( T_a \\) of a population of cells,
+ *
+ * \\( T_a' = \\epsilon(V_n) \\left( k_{T_a} V_n - T_a \\right) \\)
+ *
+ * with the normalized potential \\( V_n = (V - V_{\\rm rest})/(V_{\\rm max} - V_{\\rm rest}) \\) and the rate
+ * \\( \\epsilon(V_n) = \\epsilon_{\\rm dev} \\) if \\( V_n \\) is below a threshold (default 0.05) and \\( \\epsilon(V_n) = \\epsilon_{\\rm rec} \\) otherwise.
+ *
+ * With \\( V_n \\) frozen over a time step, both forward Euler and the exact exponential update can be written as
+ *
+ * \\( T_a^{n+1} = k_{T_a} V_n + \\left( T_a^n - k_{T_a} V_n \\right) \\delta \\)
+ *
+ * with \\( \\delta = 1 - \\epsilon \\Delta t \\) or \\( \\delta = \\exp(-\\epsilon \\Delta t) \\), respectively. The two possible
+ * factors are computed once per time step by #set_time_step, so that #step costs a few flops per cell. #step is meant to
+ * be called from the same loop that advances the membrane potential, cf. bernus_population::reaction_step, so that V is read only once.
+ *
+ * The tension of all cells is stored contiguously; it can be written directly into a buffer owned by a mechanics solver.
+ */
+class active_tension {
+
+public:
+
+  //! Time integration scheme for \\( T_a \\)
+  enum IntegrationScheme {FORWARD_EULER, EXPONENTIAL};
+
+  //! Constructor; sets the tension of all cells to zero.
+  //! @param[in] ncells Number of cells
+  //! @param[in] scheme Time integration scheme
+  //! @param[in] buffer Optional external buffer of length ncells, e.g. owned by a mechanics solver, to which the tension is written. If NULL, the tension is stored internally.
+  //! @param[in] Vrest Resting potential used for normalization in mV
+  //! @param[in] Vmax Maximum potential used for normalization in mV
+  //! @param[in] kTa Scaling of the tension
+  //! @param[in] eps_development Rate during development of tension in 1/ms
+  //! @param[in] eps_recovery Rate during recovery in 1/ms
+  //! @param[in] Vn_threshold Normalized potential below which tension develops
+  active_tension(int ncells, IntegrationScheme scheme = EXPONENTIAL, double* buffer = NULL, double Vrest = -92.189, double Vmax = 0.0,
+                 double kTa = 47.9, double eps_development = 0.04, double eps_recovery = 0.01, double Vn_threshold = 0.05);
+
+  //! Destructor
+  ~active_tension();
+
+  //! Copying is disabled since the object may point to its own internal storage
+  active_tension(active_tension const&) = delete;
+
+  //! Copying is disabled since the object may point to its own internal storage
+  active_tension& operator=(active_tension const&) = delete;
+
+  //! Precomputes the update factors for a given time step. Has to be called before #step whenever the time step changes.
+  //! @param[in] dt Length of time step in ms
+  void set_time_step(double dt);
+
+  //! Advances the tension of one cell by one time step.
+  //! @param[in] V Membrane potential of the cell at the beginning of the step in mV
+  //! @param[in] i Index of cell
+  void step(double V, int i);
+
+  //! @param[in] V Membrane potential in mV
+  //! @param[out] Vn Normalized potential
+  double normalized_potential(double V);
+
+  //! Returns the number of cells
+  int get_ncells();
+
+  //! Returns a pointer to the tension of all cells
+  double* get_tension();
+
+  //! @param[in] i Index of cell
+  //! @param[out] Ta Active tension of the cell
+  double get_tension(int i);
+
+  //! Time integration scheme
+  IntegrationScheme const scheme;
+
+  //! Resting potential used for normalization in mV
+  double const Vrest;
+
+  //! Maximum potential used for normalization in mV
+  double const Vmax;
+
+  //! Scaling \\( k_{T_a} \\) of the tension
+  double const kTa;
+
+  //! Rate \\( \\epsilon_{\\rm dev} \\) in 1/ms
+  double const eps_development;
+
+  //! Rate \\( \\epsilon_{\\rm rec} \\) in 1/ms
+  double const eps_recovery;
+
+  //! Normalized potential below which tension develops with rate #eps_development
+  double const Vn_threshold;
+
+private:
+
+  //! Number of cells
+  int const ncells;
+
+  //! Internal storage, only used if no external buffer is given
+  std::vector<double> Ta_storage;
+
+  //! Pointer to the tension of all cells, either to #Ta_storage or to an external buffer
+  double* Ta;
+
+  //! Update factor \\( \\delta \\) for \\( V_n \\) below #Vn_threshold
+  double delta_development;
+
+  //! Update factor \\( \\delta \\) for \\( V_n \\) above #Vn_threshold
+  double delta_recovery;
+
+};
+
+/*
+ * To facilitate inlining into the reaction sweep, the per-cell update is implemented here, in the header file.
+ */
+
+inline double active_tension::normalized_potential(double V) {
+  return (V - Vrest)/(Vmax - Vrest);
+}
+
+inline void active_tension::step(double V, int i) {
+  double const Vn     = normalized_potential(V);
+  double const target = kTa*Vn;
+  double const delta  = (Vn < Vn_threshold ? delta_development : delta_recovery);
+  Ta[i] = target + (Ta[i] - target)*delta;
+}
+
+#endif // ACTIVE_TENSION_HPP
@@ -73,6 +73,20 @@ public:
   
   void rush_larsen_step(double, double,std::vector<double>*);
   
+  //! Computes \\( I_{\rm ion} \\) for gating variables stored with a stride, e.g. in a structure-of-arrays layout for a population of cells.
+  //! @param[in] V Membrane potential in mV
+  //! @param[in] gates Pointer to the first gating variable; gating variable k is stored at gates[k*stride]
+  //! @param[in] stride Distance between two gating variables of the same cell
+  //! @param[out] Iion Ion current
+  double ionforcing(double V, double const* gates, int stride);
+  
+  //! Rush-Larsen step for gating variables stored with a stride, cf. #ionforcing(double, double const*, int).
+  //! @param[in] V Membrane potential at beginning of step
+  //! @param[in] dt Length of time step
+  //! @param[inout] gates Pointer to the first gating variable; gating variable k is stored at gates[k*stride]
+  //! @param[in] stride Distance between two gating variables of the same cell
+  void rush_larsen_step(double V, double dt, double* gates, int stride);
+  
   //! Static factory function that instantiates a #bernus object and returns a pointer. Called by the #IionmodelFactory class.
   //! @param[out] Iionmodel* A pointer to an object of type #bernus.
   static Iionmodel * factory() {
@@ -102,21 +116,33 @@ public:
   //! @param[out] i_Na Sodium current
   double i_na(double V, std::vector<double>* gates);
   
+  //! Variant of #i_na for gating variables stored with a stride, cf. #ionforcing(double, double const*, int).
+  double i_na(double V, double const* gates, int stride);
+  
   //! @param[in] V Membrane potential in mV
   //! @param[in] gates Vector with values of gating variables
   //! @param[out] i_Ca Calcium current
   double i_ca(double, std::vector<double>*);
   
+  //! Variant of #i_ca for gating variables stored with a stride, cf. #ionforcing(double, double const*, int).
+  double i_ca(double, double const*, int);
+  
   //! @param[in] V Membrane potential in mV
   //! @param[in] gates Vector with values of gating variables
   //! @param[out] i_to Transient outward current
   double i_to(double, std::vector<double>*);
   
+  //! Variant of #i_to for gating variables stored with a stride, cf. #ionforcing(double, double const*, int).
+  double i_to(double, double const*, int);
+  
   //! @param[in] V Membrane potential in mV
   //! @param[in] gates Vector with values of gating variables
   //! @param[out] i_k Delayed rectifier potassium current
   double i_k(double, std::vector<double>*);
   
+  //! Variant of #i_k for gating variables stored with a stride, cf. #ionforcing(double, double const*, int).
+  double i_k(double, double const*, int);
+  
   //! @param[in] V Membrane potential in mV
   //! @param[out] i_k1 Inward rectifier potassium current
   double i_k1(double);
@@ -182,7 +208,11 @@ private:
  */
 
 inline double bernus::ionforcing(double V, std::vector<double>* gates) {
-  return i_na(V,gates)+i_ca(V,gates)+i_to(V,gates)+i_k(V,gates)+i_k1(V)+i_b_ca(V)+i_b_na(V)+i_na_k(V)+i_na_ca(V);
+  return ionforcing(V, &(*gates)[0], 1);
+}
+
+inline double bernus::ionforcing(double V, double const* gates, int stride) {
+  return i_na(V,gates,stride)+i_ca(V,gates,stride)+i_to(V,gates,stride)+i_k(V,gates,stride)+i_k1(V)+i_b_ca(V)+i_b_na(V)+i_na_k(V)+i_na_ca(V);
 }
 
 inline int bernus::get_ngates() {
@@ -237,22 +267,70 @@ inline void bernus::rush_larsen_step(double V, double dt, std::vector<double>* g
   (*gates)[x_gate] += (1.0 - exp(-dt/tau_y))*y_inf;
 }
 
+inline void bernus::rush_larsen_step(double V, double dt, double* gates, int stride) {
+  
+  double y_inf;
+  double tau_y;
+  
+  // m-gate
+  y_inf = bnf.alpha_m(V)/( bnf.alpha_m(V) + bnf.beta_m(V) );
+  tau_y = 1.0/( bnf.alpha_m(V) + bnf.beta_m(V) );
+  gates[m_gate*stride] *= exp(-dt/tau_y);
+  gates[m_gate*stride] += (1.0 - exp(-dt/tau_y))*y_inf;
+  
+  // f-gate
+  y_inf = bnf.alpha_f(V)/( bnf.alpha_f(V) + bnf.beta_f(V) );
+  tau_y = 1.0/( bnf.alpha_f(V) + bnf.beta_f(V) );
+  gates[f_gate*stride] *= exp(-dt/tau_y);
+  gates[f_gate*stride] += (1.0 - exp(-dt/tau_y))*y_inf;
+  
+  // to-gate
+  y_inf = bnf.alpha_to(V)/( bnf.alpha_to(V) + bnf.beta_to(V) );
+  tau_y = 1.0/( bnf.alpha_to(V) + bnf.beta_to(V) );
+  gates[to_gate*stride] *= exp(-dt/tau_y);
+  gates[to_gate*stride] += (1.0 - exp(-dt/tau_y))*y_inf;
+  
+  // v-gate
+  y_inf = bnf.v_inf(V);
+  tau_y = bnf.tau_v(V);
+  gates[v_gate*stride] *= exp(-dt/tau_y);
+  gates[v_gate*stride] += (1.0 - exp(-dt/tau_y))*y_inf;
+  
+  // x-gate
+  y_inf = bnf.x_inf(V);
+  tau_y = bnf.tau_x(V);
+  gates[x_gate*stride] *= exp(-dt/tau_y);
+  gates[x_gate*stride] += (1.0 - exp(-dt/tau_y))*y_inf;
+}
+
 
 // Sodium current i_Na
 inline double bernus::i_na(double V,std::vector<double>* gates){
-  return g_na*pow((*gates)[m_gate], 3.0)*pow((*gates)[v_gate], 2.0)*(V - bnf.e_na);}
+  return i_na(V, &(*gates)[0], 1);}
+
+inline double bernus::i_na(double V, double const* gates, int stride){
+  return g_na*pow(gates[m_gate*stride], 3.0)*pow(gates[v_gate*stride], 2.0)*(V - bnf.e_na);}
 
 // Calcium current i_Ca
 inline double bernus::i_ca(double V,std::vector<double>* gates){
-  return g_ca*(bnf.d_inf(V))*(*gates)[f_gate]*(bnf.f_ca(V))*(V-bnf.e_ca);}
+  return i_ca(V, &(*gates)[0], 1);}
+
+inline double bernus::i_ca(double V, double const* gates, int stride){
+  return g_ca*(bnf.d_inf(V))*gates[f_gate*stride]*(bnf.f_ca(V))*(V-bnf.e_ca);}
 
 // Transient outward current i_to
 inline double bernus::i_to(double V,std::vector<double>* gates){
-  return g_to*(bnf.r_inf(V))*(*gates)[to_gate]*(V-bnf.e_to);}
+  return i_to(V, &(*gates)[0], 1);}
+
+inline double bernus::i_to(double V, double const* gates, int stride){
+  return g_to*(bnf.r_inf(V))*gates[to_gate*stride]*(V-bnf.e_to);}
 
 // Delated rectifier potassium current i_K
 inline double bernus::i_k(double V, std::vector<double>* gates){
-  return g_k*pow( (*gates)[x_gate], 2.0)*(V-bnf.e_k);}
+  return i_k(V, &(*gates)[0], 1);}
+
+inline double bernus::i_k(double V, double const* gates, int stride){
+  return g_k*pow( gates[x_gate*stride], 2.0)*(V-bnf.e_k);}
 
 // Inward rectifier potassium current i_K1
 inline double bernus::i_k1(double V){
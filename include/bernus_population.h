@@ -0,0 +1,96 @@
+#ifndef BERNUS_POPULATION_HPP
+#define BERNUS_POPULATION_HPP
+
+#include <vector>
+#include <cstdlib>
+#include <stdexcept>
+#include <assert.h>
+#include "bernus.h"
+#include "active_tension.h"
+
+/**
+ * Gating variables of the Bernus model for a population of cells, stored as structure of arrays: gating variable k of
+ * cell i is stored at gates[k*ncells + i], so that every gating variable of a range of cells is contiguous in memory.
+ *
+ * #reaction_step advances membrane potentials and gating variables over one reaction step of an operator splitting
+ * scheme, taking nsub substeps of length dt/nsub (forward Euler for V, Rush-Larsen for the gates). Cells are processed
+ * in blocks of #block_size cells: all substeps are done for one block before moving to the next, so that with a block that
+ * fits into L1/L2 cache the gating variables and the potential are streamed through main memory only once per reaction step
+ * instead of once per substep. With #block_size equal to the number of cells this reduces to the naive sweep over all cells for
+ * every substep. Blocks are distributed over threads with OpenMP if enabled at compile time.
+ * If an #active_tension object is passed to #reaction_step, the tension of every cell is advanced in the same pass,
+ * using the potential at the beginning of each substep.
+ */
+class bernus_population {
+
+public:
+
+  //! Constructor; initializes the gating variables of all cells to their resting values, cf. bernus::initialize.
+  //! @param[in] ncells Number of cells
+  //! @param[in] block_size Number of cells per cache block; values smaller than one or larger than ncells select the naive sweep
+  //! @param[in] capacitance Membrane capacitance
+  bernus_population(int ncells, int block_size, double capacitance = 1.0);
+
+  //! Destructor
+  ~bernus_population();
+
+  //! Advances membrane potentials and gating variables of all cells by one reaction step.
+  //! @param[inout] V Vector of length #ncells with membrane potentials in mV
+  //! @param[in] dt Length of the reaction step in ms
+  //! @param[in] nsub Number of substeps of length dt/nsub
+  //! @param[inout] tension Optional active tension model for the same cells, advanced together with the potential
+  void reaction_step(std::vector<double>* V, double dt, int nsub, active_tension* tension = NULL);
+
+  //! Returns the number of cells
+  int get_ncells();
+
+  //! Returns the number of cells per cache block
+  int get_block_size();
+
+  //! Sets the number of cells per cache block; values smaller than one or larger than #ncells select the naive sweep
+  void set_block_size(int block_size);
+
+  //! Model estimate of the main memory traffic in bytes per cell and substep of #reaction_step with the current #block_size: the gating
+  //! variables, the potential and, if present, the active tension of a cell are read and written once per reaction step if the cells
+  //! processed together (a block, or all cells for the naive sweep) fit into a cache of the given size, and once per substep otherwise.
+  //! @param[in] nsub Number of substeps per reaction step
+  //! @param[in] cache_bytes Size of the cache available to one block in bytes
+  //! @param[in] tension Active tension model passed to #reaction_step or NULL
+  //! @param[out] traffic Bytes per cell and substep
+  double traffic_per_cell_step(int nsub, double cache_bytes, active_tension* tension = NULL);
+
+  //! @param[in] gate Index of gating variable, e.g. bernus::m_gate
+  //! @param[in] cell Index of cell
+  //! @param[out] value Value of gating variable
+  double get_gate(int gate, int cell);
+
+  //! Membrane capacitance
+  double const capacitance;
+
+private:
+
+  //! Advances potential and gating variables of a single cell by one substep
+  //! @param[inout] v Pointer to the potentials of all cells
+  //! @param[in] i Index of cell
+  //! @param[in] dt Length of substep
+  //! @param[inout] tension Active tension model or NULL
+  void cell_step(double* v, int i, double dt, active_tension* tension);
+
+  //! Model providing the ion currents and the Rush-Larsen step; declared first since #ngates is initialized from it
+  bernus brn;
+
+  //! Number of cells
+  int const ncells;
+
+  //! Number of gating variables per cell
+  int const ngates;
+
+  //! Number of cells per cache block
+  int block_size;
+
+  //! Gating variables, entry gate*ncells + cell
+  std::vector<double> gates;
+
+};
+
+#endif // BERNUS_POPULATION_HPP
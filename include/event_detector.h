@@ -0,0 +1,202 @@
+#ifndef EVENT_DETECTOR_HPP
+#define EVENT_DETECTOR_HPP
+
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <assert.h>
+#include <cstdlib>
+#include <stdexcept>
+#include <limits>
+
+/**
+ * Online detection of activation and repolarization events for a population of cells. Instead of storing the full
+ * membrane potential \\( V(t) \\) of every cell and post-processing it, #update is called once per time step with
+ * the current potentials and the detector tracks for every cell and every beat
+ * - the activation time, defined as the upward crossing of the threshold #v_act,
+ * - the maximum upstroke velocity \\( \\max dV/dt \\),
+ * - the repolarization time, defined as the downward crossing of the level
+ *   \\( V_{\\rm peak} - r ( V_{\\rm peak} - V_{\\rm min} ) \\), where \\( V_{\\rm peak} \\) is the peak potential of the beat,
+ *   \\( V_{\\rm min} \\) the diastolic potential before the upstroke and \\( r \\) is #repol_level (0.9 gives APD90),
+ * - the action potential duration (APD) as difference between repolarization and activation time.
+ *
+ * Crossing times are linearly interpolated between the two time steps enclosing the crossing.
+ * All per-cell quantities are stored as separate contiguous arrays (structure of arrays) so that the per-step
+ * sweep in #update only streams through a few doubles per cell. Storage for a new beat is allocated in a short pre-pass,
+ * so that the main sweep is written with branch-free selects and can be parallelized with OpenMP if enabled at compile time.
+ * The results are kept as compact maps with one entry per cell and beat; entries that are not (yet) available are NaN.
+ * The max dV/dt of a beat is available from its activation on, the other quantities once the cell has repolarized.
+ */
+class event_detector {
+
+public:
+
+  //! Constructor
+  //! @param[in] ncells Number of cells in the population
+  //! @param[in] v_act Activation threshold in mV
+  //! @param[in] repol_level Fraction of the action potential amplitude at which repolarization is detected, e.g. 0.9 for APD90
+  event_detector(int ncells, double v_act = -40.0, double repol_level = 0.9);
+
+  //! Destructor
+  ~event_detector();
+
+  //! Sets the initial potential of all cells, typically the resting potential, which is also the diastolic reference
+  //! potential of the first beat. Has to be called once before the first call to #update.
+  //! @param[in] V Vector of length #ncells with membrane potentials in mV
+  void initialize(std::vector<double>* V);
+
+  //! Detects events for all cells from the potentials at the end of a time step.
+  //! @param[in] t Time at the end of the step in ms
+  //! @param[in] dt Length of the time step in ms
+  //! @param[in] V Vector of length #ncells with membrane potentials in mV at time t
+  void update(double t, double dt, std::vector<double>* V);
+
+  //! Returns the number of cells
+  int get_ncells();
+
+  //! Returns the number of beats for which maps are stored, i.e. the maximum number of activations of any cell
+  int get_nbeats();
+
+  //! @param[in] beat Index of beat
+  //! @param[in] cell Index of cell
+  //! @param[out] t_act Activation time in ms, NaN if not available
+  double activation_time(int beat, int cell);
+
+  //! @param[in] beat Index of beat
+  //! @param[in] cell Index of cell
+  //! @param[out] t_repol Repolarization time in ms, NaN if not available
+  double repolarization_time(int beat, int cell);
+
+  //! @param[in] beat Index of beat
+  //! @param[in] cell Index of cell
+  //! @param[out] apd Action potential duration in ms, NaN if not available
+  double apd(int beat, int cell);
+
+  //! @param[in] beat Index of beat
+  //! @param[in] cell Index of cell
+  //! @param[out] dvdt_max Maximum upstroke velocity in mV/ms, NaN if not available
+  double dvdt_max(int beat, int cell);
+
+  //! Writes activation, repolarization, APD and max dV/dt maps as plain text, one line per beat and cell with the columns
+  //! beat, cell, activation time, repolarization time, APD, max dV/dt.
+  //! @param[in] filename Name of output file
+  void write_maps(std::string filename);
+
+  //! Activation threshold in mV
+  double const v_act;
+
+  //! Fraction of the action potential amplitude at which repolarization is detected
+  double const repol_level;
+
+private:
+
+  //! Returns the index of an entry in the maps; throws if beat or cell are out of range
+  int index(int beat, int cell);
+
+  //! Resizes all maps to hold the given number of beats; new entries are NaN
+  //! @param[in] nbeats_new Number of beats
+  void resize_maps(int nbeats_new);
+
+  //! Minimum number of cells for which the sweeps in #update run in parallel; for fewer cells the overhead of a parallel region dominates
+  static const int omp_min_cells = 4096;
+
+  //! Number of cells
+  int const ncells;
+
+  //! Number of beats stored in the maps; the maps hold at least one beat so that every cell has a valid entry
+  int nbeats;
+
+  //! Potential at the previous time step
+  std::vector<double> v_prev;
+
+  //! Minimum (diastolic) potential since the last repolarization
+  std::vector<double> v_min;
+
+  //! Peak potential of the current beat
+  std::vector<double> v_peak;
+
+  //! Maximum dV/dt of the current beat
+  std::vector<double> dvdt_cur;
+
+  //! Index of the current beat, -1 before the first activation
+  std::vector<int> beat;
+
+  //! 1 between activation and repolarization, 0 otherwise
+  std::vector<int> active;
+
+  //! Activation map, entry beat*ncells + cell
+  std::vector<double> act_map;
+
+  //! Repolarization map, entry beat*ncells + cell
+  std::vector<double> repol_map;
+
+  //! APD map, entry beat*ncells + cell
+  std::vector<double> apd_map;
+
+  //! Maximum dV/dt map, entry beat*ncells + cell
+  std::vector<double> dvdt_map;
+
+};
+
+/*
+ * The per-step sweep is implemented here, in the header file, to facilitate inlining into the time-stepping loop.
+ */
+
+inline void event_detector::update(double t, double dt, std::vector<double>* V) {
+
+  assert( (int) (*V).size() >= ncells );
+
+  double const* vv = &(*V)[0];
+
+  // Pre-pass: number of beats required if activating cells start a new beat
+  int nbeats_new = nbeats;
+
+  #pragma omp parallel for reduction(max:nbeats_new) if(ncells >= omp_min_cells)
+  for (int i=0; i<ncells; ++i) {
+    int const act_now = (active[i]==0) & (v_prev[i] < v_act) & (vv[i] >= v_act);
+    nbeats_new = std::max(nbeats_new, act_now ? beat[i]+2 : 0);
+  }
+
+  if (nbeats_new > nbeats) resize_maps(nbeats_new);
+
+  #pragma omp parallel for if(ncells >= omp_min_cells)
+  for (int i=0; i<ncells; ++i) {
+
+    double const v    = vv[i];
+    double const vp   = v_prev[i];
+    double const dvdt = (v - vp)/dt;
+    int const was_active = active[i];
+
+    // upward crossing of activation threshold
+    int const act_now = (was_active==0) & (vp < v_act) & (v >= v_act);
+    int const b       = beat[i] + act_now;
+    int const k       = std::max(b, 0)*ncells + i;
+
+    double const peak   = act_now ? v    : std::max(v_peak[i], v);
+    double const dvdt_c = act_now ? dvdt : std::max(dvdt_cur[i], dvdt);
+
+    // downward crossing of repolarization level
+    double const v_repol   = peak - repol_level*(peak - v_min[i]);
+    int const repol_now    = was_active & (vp >= v_repol) & (v < v_repol);
+    int const is_active    = was_active | act_now;
+
+    // Crossing times; only used if the respective crossing took place, where v != vp
+    double const t_act_now   = t - dt*(v - v_act)/(v - vp);
+    double const t_repol_now = t - dt*(v - v_repol)/(v - vp);
+
+    act_map[k]   = act_now   ? t_act_now               : act_map[k];
+    repol_map[k] = repol_now ? t_repol_now             : repol_map[k];
+    apd_map[k]   = repol_now ? t_repol_now - act_map[k] : apd_map[k];
+    dvdt_map[k]  = is_active ? dvdt_c                  : dvdt_map[k];
+
+    v_min[i]    = repol_now ? v : ( is_active ? v_min[i] : std::min(v_min[i], v) );
+    v_peak[i]   = peak;
+    dvdt_cur[i] = dvdt_c;
+    beat[i]     = b;
+    active[i]   = is_active & (1 - repol_now);
+    v_prev[i]   = v;
+  }
+
+}
+
+#endif // EVENT_DETECTOR_HPP
@@ -0,0 +1,103 @@
+#ifndef PSEUDO_ECG_HPP
+#define PSEUDO_ECG_HPP
+
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <stdexcept>
+#include <assert.h>
+
+/**
+ * Streaming computation of pseudo-ECG leads for a population of cells on a uniform grid. The extracellular potential
+ * at an electrode position \\( x' \\) is approximated by
+ *
+ * \\( \\phi(x') = -K \\int_{\\Omega} \\nabla V(x) \\cdot \\nabla \\frac{1}{|x - x'|}~dx \\)
+ *
+ * with a scaling constant \\( K \\) (#scale), see e.g. R. Plonsey, R. C. Barr: "Bioelectricity: A quantitative approach".
+ * The integral is discretized by the midpoint rule on the grid, with \\( \\nabla V \\) approximated by central differences in the
+ * interior and one-sided differences at the boundary. Since this is linear in V, the difference stencil is folded into the lead-field
+ * weights \\( -K h^3 \\nabla (1/r) \\) once in the constructor, leaving one weight per cell and lead. Each call to #record is then a
+ * batched dot product of V with the weights of all leads, so that only a small time series per lead is stored instead of the full
+ * potential field. Cells are processed in chunks that stay in cache while they are multiplied with the weights of all leads;
+ * chunks are distributed over threads with OpenMP if enabled at compile time, using per-thread partial sums of all leads.
+ *
+ * Cells are numbered as \\( i = i_x + n_x ( i_y + n_y i_z ) \\) and cell \\( (i_x, i_y, i_z) \\) is located at \\( h (i_x, i_y, i_z) \\).
+ */
+class pseudo_ecg {
+
+public:
+
+  //! Constructor; precomputes the lead-field weights.
+  //! @param[in] nx Number of cells in x direction
+  //! @param[in] ny Number of cells in y direction
+  //! @param[in] nz Number of cells in z direction
+  //! @param[in] h Grid spacing
+  //! @param[in] electrodes Vector with coordinates x, y, z of all electrodes, one triplet per lead
+  //! @param[in] scale Scaling constant \\( K \\)
+  pseudo_ecg(int nx, int ny, int nz, double h, std::vector<double>* electrodes, double scale = 1.0);
+
+  //! Destructor
+  ~pseudo_ecg();
+
+  //! Computes all leads for the current membrane potentials and appends them to the stored time series.
+  //! @param[in] t Time in ms
+  //! @param[in] V Vector of length nx*ny*nz with membrane potentials in mV
+  void record(double t, std::vector<double>* V);
+
+  //! Returns the number of leads
+  int get_nleads();
+
+  //! Returns the number of recorded samples
+  int get_nsamples();
+
+  //! @param[in] sample Index of sample
+  //! @param[in] lead Index of lead
+  //! @param[out] phi Value of lead at the given sample
+  double get_signal(int sample, int lead);
+
+  //! Writes all recorded samples as plain text, one line per sample with the time followed by the value of every lead.
+  //! @param[in] filename Name of output file
+  void write(std::string filename);
+
+  //! Scaling constant \\( K \\)
+  double const scale;
+
+private:
+
+  //! Adds the weights of a difference approximation of the derivative in one direction at cell i, multiplied by c, to w:
+  //! central differences in the interior, one-sided differences at the boundary, nothing if there is only one cell in that direction.
+  //! @param[inout] w Pointer to the weights of one lead
+  //! @param[in] i Index of cell
+  //! @param[in] j Index of cell in the given direction
+  //! @param[in] n Number of cells in the given direction
+  //! @param[in] stride Distance between neighbouring cells in the given direction
+  //! @param[in] c Factor
+  void add_difference(double* w, int i, int j, int n, int stride, double c);
+
+  //! Number of cells per chunk in #record
+  static const int chunk_size = 4096;
+
+  //! Number of cells in x, y and z direction
+  int const nx, ny, nz;
+
+  //! Total number of cells
+  int const ncells;
+
+  //! Number of leads
+  int const nleads;
+
+  //! Grid spacing
+  double const h;
+
+  //! Lead-field weights with folded difference stencil, entry lead*ncells + cell
+  std::vector<double> weights;
+
+  //! Times of recorded samples
+  std::vector<double> times;
+
+  //! Recorded samples, entry sample*nleads + lead
+  std::vector<double> signals;
+
+};
+
+#endif // PSEUDO_ECG_HPP